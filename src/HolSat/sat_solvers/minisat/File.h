@@ -25,6 +25,8 @@ enum FileMode { READ, WRITE };
 
 class Exception_EOF {};
 
+uint crc32(uint crc, const uchar* data, int64 len);     // (CRC-32 as in zlib, continuing from 'crc')
+
 
 // WARNING! This code is not thoroughly tested. May contain bugs!
 
@@ -35,9 +37,10 @@ class File {
     int         size;       // Size of buffer (at end of file, less than 'File_BufSize').
     int         pos;        // Current position in buffer
     bool        own_fd;     // Do we own the file descriptor? If so, will close file in destructor.
+    uint        crc;        // CRC-32 of the bytes written (the contents, if the file is only appended to).
 
 public:
-    #define DEFAULTS fd(-1), mode(READ), buf(NULL), size(-1), pos(0), own_fd(true)
+    #define DEFAULTS fd(-1), mode(READ), buf(NULL), size(-1), pos(0), own_fd(true), crc(0)
     File(void) : DEFAULTS {}
 
     File(int fd, FileMode mode, bool own_fd = true) : DEFAULTS  {
@@ -68,6 +71,12 @@ public:
     FileMode getMode(void) {
         return mode; }
 
+    int descriptor(void) {
+        return fd; }
+
+    uint checksum(void) {           // (call 'flush()' first)
+        return crc; }
+
     void setMode(FileMode m) {
         if (m == mode) return;
         if (m == READ){
@@ -95,6 +104,7 @@ public:
         assert(mode == WRITE);
       #endif
         if (pos == File_BufSize)
+            crc = crc32(crc, buf, File_BufSize),
             write(fd, buf, File_BufSize),
             pos = 0;
         return buf[pos++] = (uchar)chr; }
@@ -118,6 +128,7 @@ public:
 
     void flush(void) {
         assert(mode == WRITE);
+        crc = crc32(crc, buf, pos);
         write(fd, buf, pos);
         pos = 0; }
 
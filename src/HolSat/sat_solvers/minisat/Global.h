@@ -100,9 +100,15 @@ static inline int irand(double& seed, int size) {
 static inline double cpuTime(void) {
     return (double)clock() / CLOCKS_PER_SEC; }
 
+static inline double realTime(void) {
+    return (double)time(NULL); }
+
 static inline int64 memUsed() {
     return 0; }
 
+static inline int64 memPeak() {
+    return 0; }
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 #else
 
@@ -115,6 +121,11 @@ static inline double cpuTime(void) {
     getrusage(RUSAGE_SELF, &ru);
     return (double)ru.ru_utime.tv_sec + (double)ru.ru_utime.tv_usec / 1000000; }
 
+static inline double realTime(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (double)tv.tv_sec + (double)tv.tv_usec / 1000000; }
+
 static inline int memReadStat(int field)
 {
     char    name[256];
@@ -131,6 +142,11 @@ static inline int memReadStat(int field)
 
 static inline int64 memUsed() { return (int64)memReadStat(0) * (int64)getpagesize(); }
 
+static inline int64 memPeak() {     // (peak resident set size)
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return (int64)ru.ru_maxrss * 1024; }
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 #endif
 
@@ -96,5 +96,90 @@ class Heap {
 };
 
 
+//=================================================================================================
+// ActHeap -- a 4-ary max-heap of variables. The activity is stored inline with each element (as a
+// copy of the solver's 'activity[x]'), so percolating compares adjacent memory only and each level
+// spans a cache line. A variable's key must be refreshed through 'increase()' when its activity
+// grows, and all keys scaled through 'rescale()' when the activities are.
+
+
+class ActHeap {
+    struct Elem { float act; int var; };
+    vec<Elem> heap;     // heap of (activity, var) pairs, root at index 0
+    vec<int>  indices;  // var -> index in heap (-1 if not in heap)
+
+    static inline int child (int i) { return 4*i + 1; }      // (first of up to four children)
+    static inline int up    (int i) { return (i-1) >> 2; }
+
+    inline void percolateUp(int i)
+    {
+        Elem x = heap[i];
+        while (i != 0 && x.act > heap[up(i)].act){
+            heap[i]               = heap[up(i)];
+            indices[heap[i].var]  = i;
+            i                     = up(i);
+        }
+        heap   [i]     = x;
+        indices[x.var] = i;
+    }
+
+    inline void percolateDown(int i)
+    {
+        Elem x = heap[i];
+        while (child(i) < heap.size()){
+            int c    = child(i);
+            int end  = c + 4 < heap.size() ? c + 4 : heap.size();
+            for (int k = c + 1; k < end; k++)
+                if (heap[k].act > heap[c].act) c = k;
+            if (!(heap[c].act > x.act)) break;
+            heap[i]               = heap[c];
+            indices[heap[i].var]  = i;
+            i                     = c;
+        }
+        heap   [i]     = x;
+        indices[x.var] = i;
+    }
+
+    bool ok(int n) { return n >= 0 && n < (int)indices.size(); }
+
+  public:
+    void setBounds (int size) { assert(size >= 0); indices.growTo(size,-1); }
+    bool inHeap    (int n)    { assert(ok(n)); return indices[n] >= 0; }
+    bool empty     ()         { return heap.size() == 0; }
+    int  top       ()         { assert(!empty()); return heap[0].var; }
+
+    void increase(int n, float act) {
+        assert(ok(n)); assert(inHeap(n)); assert(act >= heap[indices[n]].act);
+        heap[indices[n]].act = act;
+        percolateUp(indices[n]); }
+
+    void insert(int n, float act) {
+        assert(ok(n)); assert(!inHeap(n));
+        Elem e; e.act = act; e.var = n;
+        indices[n] = heap.size();
+        heap.push(e);
+        percolateUp(indices[n]); }
+
+    int  getmax() {
+        int r = heap[0].var;
+        heap[0] = heap.last();
+        indices[heap[0].var] = 0;
+        indices[r]           = -1;
+        heap.pop();
+        if (heap.size() > 1)
+            percolateDown(0);
+        return r; }
+
+    void rescale(float factor) {        // (scaling all keys alike keeps the heap property)
+        for (int i = 0; i < heap.size(); i++)
+            heap[i].act *= factor; }
+
+    bool heapProperty() {
+        for (int i = 1; i < heap.size(); i++)
+            if (heap[i].act > heap[up(i)].act) return false;
+        return true; }
+};
+
+
 //=================================================================================================
 #endif
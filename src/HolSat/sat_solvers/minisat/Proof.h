@@ -45,28 +45,50 @@ struct ProofTraverser {
 class Proof {
     File            fp;
     cchar*          fp_name;
+    File            out;        // Copy of the trace streamed to a pipe (or file) as it is written.
     ClauseId        id_counter;
     ClauseId        root_counter;
+    int64           res_counter;
     ProofTraverser* trav;
 
     vec<Lit>        clause;
     vec<ClauseId>   chain_id;
     vec<Var>        chain_var;
+    vec<vec<ClauseId> > saved_id;       // (chains put aside by 'pushChain()')
+    vec<vec<Var> >  saved_var;
     vec<int64>      c2fp; // c2fp[id] gives position in proof trace of clause with id 'id'
 
+    void put(uint64 val) { if (!fp.null()) putUInt(fp, val); if (!out.null()) putUInt(out, val); }
+
 public:
     Proof();                        // Offline mode -- proof stored to a file, which can be saved, compressed, and/or traversed.
     Proof(ClauseId goal); // Offline mode -- for pre-initialising c2fp
     Proof(ProofTraverser& t);       // Online mode -- proof will not be stored.
 
     void     incRootCount () { root_counter++; }
-    ClauseId addRoot   (vec<Lit>& clause, ClauseId orig_root_id = -1);
+    ClauseId rootCount    () { return root_counter; }     // (index the next input clause will get)
+    ClauseId addRoot   (vec<Lit>& clause, ClauseId orig_root_id = -1);   // (an explicit 'orig_root_id' does not advance the root count)
     void     beginChain(ClauseId start);
     void     resolve   (ClauseId next, Var x);
     void     resolve   (ClauseId next, Lit p);
     ClauseId endChain  ();
+    void     pushChain ();      // Put the chain being built aside (other chains may then be logged),
+    void     popChain  ();      // and continue it.
     void     deleted   (ClauseId gone);
     ClauseId last      () { assert(id_counter != ClauseId_NULL); return id_counter - 1; }
+    int64    resolutions() { return res_counter; }    // (in the chains logged so far)
+    void     flush     () { if (!fp.null()){ fp.setMode(WRITE); fp.flush(); } if (!out.null()) out.flush(); }
+
+    // Streaming: every record is also written to 'target' (a named pipe or file, or a descriptor
+    // given as a number) as soon as it is logged, so a reader can replay the trace while the search
+    // runs. 'finish()' ends the stream with the marker record "0 <r>", where <r> is 1 for UNSAT,
+    // 2 for SAT and 3 for UNKNOWN (no root clause has index 0), and closes it.
+    bool     stream    (cchar* target);
+    void     finish    (lbool result);
+
+    void     reset     ();                   // (offline mode) start over with an empty trace
+    bool     detach    (cchar* filename);    // (in a forked child) log to this new file from now on
+    bool     splice    (cchar* filename, ClauseId base, vec<ClauseId>& ids);
 
 #ifdef DEBUG
     ClauseId parseRoot (vec<Lit>& clause, File& fp, uint64 tmp, std::ofstream* fout = NULL);
@@ -77,7 +99,7 @@ public:
 #endif
 
     void     compress  (Proof& dst, ClauseId goal = ClauseId_NULL);     // 'dst' should be a newly constructed, empty proof.
-    bool     save      (cchar* filename);
+    bool     save      (cchar* filename, bool done = false);   // (see 'Proof.C')
     void   traverse  (ProofTraverser& trav, int& res_count, ClauseId goal = ClauseId_NULL) ;
 
 };
@@ -24,6 +24,8 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "VarOrder.h"
 #include "Proof.h"
 
+struct XorRow;
+
 // Redfine if you want output to go somewhere else:
 #define reportf(format, args...) ( printf(format , ## args), fflush(stdout) )
 
@@ -35,8 +37,27 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 struct SolverStats {
     int64   starts, decisions, propagations, conflicts;
     int64   clauses_literals, learnts_literals, max_literals, tot_literals;
+    int64   inprocessings, removed_literals, substituted_vars;
+    int64   probes, probed_units, probed_equivs, hyper_binaries;
+    int64   xors, xor_rows, xor_explanations;
+    int64   card_explanations;
+    int64   flips;
+    int64   kept_decisions, chrono_backtracks;
     SolverStats() : starts(0), decisions(0), propagations(0), conflicts(0)
-      , clauses_literals(0), learnts_literals(0), max_literals(0), tot_literals(0) { }
+      , clauses_literals(0), learnts_literals(0), max_literals(0), tot_literals(0)
+      , inprocessings(0), removed_literals(0), substituted_vars(0)
+      , probes(0), probed_units(0), probed_equivs(0), hyper_binaries(0)
+      , xors(0), xor_rows(0), xor_explanations(0), card_explanations(0), flips(0), kept_decisions(0), chrono_backtracks(0) { }
+};
+
+
+// The assignment data of a variable that conflict analysis reads together, packed in 16 bytes. (The
+// sign of the variable in its reason, needed for proof logging, is that of its value.)
+//
+struct VarData {
+    Clause* reason;     // The clause that implied the variable's current value, or 'NULL' if none.
+    int     level;      // The decision level at which the assignment was made.
+    int     trail_pos;  // The variable's position in 'trail[]'.
 };
 
 
@@ -54,59 +75,123 @@ protected:
     vec<Clause*>        clauses;          // List of problem clauses.
     vec<Clause*>        learnts;          // List of learnt clauses.
     vec<ClauseId>       unit_id;          // 'unit_id[var]' is the clause ID for the unit literal 'var' or '~var' (if set at toplevel).
+    vec<Card*>          cards;            // List of cardinality constraints.
+    vec<Xor*>           xors;             // List of XOR constraints (the rows left by 'gaussEliminate()').
     double              cla_inc;          // Amount to bump next clause with.
     double              cla_decay;        // INVERSE decay factor for clause activity: stores 1/decay.
 
-    vec<double>         activity;         // A heuristic measurement of the activity of a variable.
+    vec<float>          activity;         // A heuristic measurement of the activity of a variable. (float: rescaled at 1e20)
     double              var_inc;          // Amount to bump next variable with.
     double              var_decay;        // INVERSE decay factor for variable activity: stores 1/decay. Use negative value for static variable order.
+    vec<char>           decision;         // 'decision[var]' is TRUE if the variable may be branched on (see 'setDecisionVar()').
+    vec<char>           phase;            // 'phase[var]' is the value the variable had when it was last unassigned (lbool stored as char). Seeds local search.
     VarOrder            order;            // Keeps track of the decision variable order.
 
     vec<vec<Clause*> >  watches;          // 'watches[lit]' is a list of constraints watching 'lit' (will go there if literal becomes true).
+    vec<vec<Card*> >    card_watches;     // 'card_watches[lit]' is the same for cardinality constraints.
+    vec<vec<Xor*> >     xor_watches;      // 'xor_watches[var]' is a list of XOR constraints watching 'var' (will go there if it is assigned).
+    vec<char>           frozen;           // 'frozen[var]' is TRUE if the variable is never substituted (it occurs in a cardinality or XOR constraint, or splits cubes).
     vec<char>           assigns;          // The current assignments (lbool:s stored as char:s).
     vec<Lit>            trail;            // Assignment stack; stores all assigments made in the order they were made.
     vec<int>            trail_lim;        // Separator indices for different decision levels in 'trail[]'.
-    vec<Clause*>        reason;           // 'reason[var]' is the clause that implied the variables current value, or 'NULL' if none.
-    vec<bool>           sreason;          // true if var is negated in reason[var]. used to write out pivot sign info to proof log 
-    vec<int>            level;            // 'level[var]' is the decision level at which assignment was made.
-    vec<int>            trail_pos;        // 'trail_pos[var]' is the variable's position in 'trail[]'. This supersedes 'level[]' in some sense, and 'level[]' will probably be removed in future releases.
+    vec<VarData>        vardata;          // 'vardata[var]' holds the reason, level and trail position of the variable (see 'VarData').
+    vec<Card*>          card_reason;      // 'card_reason[var]' is the cardinality constraint that implied the variable. Its explanation is put in 'reason()' when first needed.
+    Clause*             card_confl;       // Explanation of the last conflicting cardinality constraint (freed at the next one).
+    vec<Xor*>           xor_reason;       // 'xor_reason[var]' is the same for XOR constraints.
+    Clause*             xor_confl;        // Explanation of the last conflicting XOR constraint (freed at the next one).
+    vec<XorRow*>        xor_found;        // (proof logging only) The XOR constraints recovered from the problem clauses, referred to by 'Xor::from'.
+    vec<ClauseId>       xor_pinned;       // (proof logging only) The IDs of their clauses, sorted. Never logged as deleted, since explanations are derived from them.
     int                 root_level;       // Level of first proper decision.
+    bool                chrono_on;        // Chronological backtracking is in use: the trail may hold literals of lower levels after higher ones.
     int                 qhead;            // Head of queue (as index into the trail -- no more explicit propagation queue in MiniSat).
     int                 simpDB_assigns;   // Number of top-level assignments since last execution of 'simplifyDB()'.
     int64               simpDB_props;     // Remaining number of propagations that must be made before next execution of 'simplifyDB()'.
+    double              solve_start;      // Wall-clock time at which the current call to 'solve()' started.
+    int                 budget_countdown; // Number of calls to 'withinBudget()' left before time and memory are sampled again.
+    bool                budget_out;       // TRUE once one of the resource budgets has been exhausted (sticky until next 'solve()').
+    vec<Lit>            subst;            // 'subst[var]' is the literal that 'Lit(var)' was found equivalent to and replaced by, or 'lit_Undef'.
+    vec<Var>            subst_order;      // Substituted variables in the order they were replaced (for extending models).
+    int64               inprocess_next;   // Run 'inprocess()' again when 'stats.conflicts' reaches this value.
+    int64               inprocess_props;  // Value of 'stats.propagations' at the end of the last 'inprocess()'.
+    Var                 probe_next;       // Variable at which the next 'probe()' starts.
+    bool                gauss_done;       // TRUE once 'gaussEliminate()' has been run.
+    double              random_seed;      // For the random choices of local search.
 
     // Temporaries (to reduce allocation overhead). Each variable is prefixed by the method in which is used:
     //
     vec<char>           analyze_seen;
     vec<Lit>            analyze_stack;
     vec<Lit>            analyze_toclear;
+    vec<Var>            analyze_units;      // (level 0 variables to resolve away at the end of the chain, with 'proof_economy')
     Clause*             propagate_tmpbin;
     Clause*             analyze_tmpbin;
     vec<Lit>            addUnit_tmp;
     vec<Lit>            addBinary_tmp;
     vec<Lit>            addTernary_tmp;
+    vec<Lit>            cancelUntil_kept;
 
     // Main internal methods:
     //
     bool        assume           (Lit p);
     void        cancelUntil      (int level);
+    int         reuseTrail       ();
     void        record           (const vec<Lit>& clause);
 
     void        analyze          (Clause* confl, vec<Lit>& out_learnt, int& out_btlevel); // (bt = backtrack)
     bool        analyze_removable(Lit p, uint min_level);                                 // (helper method for 'analyze()')
     void        analyzeFinal     (Clause* confl, bool skip_first = false);
     bool        enqueue          (Lit fact, Clause* from = NULL);
+    int         reasonLevel      (const Clause& c);
+    void        logUnit          (Clause& c);
+    ClauseId    unitId           (Var x) { return unit_id[x] != ClauseId_NULL ? unit_id[x] : logLazyUnit(x); }
+    ClauseId    logLazyUnit      (Var x);
+    int         conflictLevel    (Clause& c);
     Clause*     propagate        ();
+    Clause*     propagateCards   (Lit p);
+    void        cardImply        (Card& c, Lit p);
+    Clause*     cardConflict     (Card& c, Lit false_lit);
+    void        cardExplain      (const Card& c, Lit p, vec<Lit>& out);
+    Clause*     newExplanation   (const Card& c, vec<Lit>& ps);
+    void        freeExplanation  (Clause* c) { if (proof != NULL && !xorPinned(c->id())) proof->deleted(c->id()); xfree(c); }
+    Clause*     propagateXors    (Var x);
+    Clause*     xorImply         (Xor& c, Lit p);
+    Clause*     xorConflict      (Xor& c, Var x);
+    bool        xorOpen          (const Xor& c);
+    ClauseId    xorExplain       (const Xor& c, Lit p, int known_pos, vec<Lit>& out, bool log);
+    bool        xorPinned        (ClauseId id) const;
+    Clause*     reasonOf         (Var x);
     void        reduceDB         ();
     Lit         pickBranchLit    (const SearchParams& params);
     lbool       search           (int nof_conflicts, int nof_learnts, const SearchParams& params);
+    bool        withinBudget     ();
+    void        unsubstConflict  (const vec<Lit>& assumps);
+
+    // Inprocessing:
+    //
+    void        inprocess        ();
+    void        strengthenDB     ();
+    void        substituteEquivalences();
+    void        vivifyLearnts    (int64 budget);
+    void        probe            (int64 budget);
+    bool        probeLit         (Lit p);
+    ClauseId    probeImplication (Lit q, vec<Lit>& out, bool& is_new);
+    void        findXors         (vec<XorRow*>& rows);
+    void        gaussEliminate   ();
+    void        deleteXorRows    ();
+    bool        analyzeVivify    (Clause* start, Lit keep, vec<Lit>& out, bool log);
+    lbool       localSearch      (int64 max_flips);
+    void        extendModel      ();
+    Var         lookahead        (const vec<int>& occ);
+    void        cubeSplit        (int depth, vec<Lit>& prefix, const vec<int>& occ, vec<vec<Lit> >& out);
+    Clause*     addDerived       (const vec<Lit>& ps, bool learnt, ClauseId id);
+    Lit         liveLit          (Lit p) const { while (subst[var(p)] != lit_Undef) p = id(subst[var(p)], sign(p)); return p; }
     double      progressEstimate ();
 
     // Activity:
     //
     void     varBumpActivity(Lit p) {
         if (var_decay < 0) return;     // (negative decay means static variable order -- don't bump)
-        if ( (activity[var(p)] += var_inc) > 1e100 ) varRescaleActivity();
+        if ( (activity[var(p)] += var_inc) > 1e20 ) varRescaleActivity();
         order.update(var(p)); }
     void     varDecayActivity  () { if (var_decay >= 0) var_inc *= var_decay; }
     void     varRescaleActivity();
@@ -118,25 +203,55 @@ protected:
     void     newClause(const vec<Lit>& ps, bool learnt = false, ClauseId id = ClauseId_NULL);
     void     claBumpActivity (Clause* c) { if ( (c->activity() += cla_inc) > 1e20 ) claRescaleActivity(); }
     void     remove          (Clause* c, bool just_dealloc = false);
-    bool     locked          (const Clause* c) const { return reason[var((*c)[0])] == c; }
+    bool     locked          (const Clause* c) const { return reason(var((*c)[0])) == c; }
     bool     simplify        (Clause* c) const;
 
     int      decisionLevel() const { return trail_lim.size(); }
 
+    Clause*&       reason  (Var x)       { return vardata[x].reason; }
+    Clause*        reason  (Var x) const { return vardata[x].reason; }
+    int&           level   (Var x)       { return vardata[x].level; }
+    int            level   (Var x) const { return vardata[x].level; }
+    int&           trailPos(Var x)       { return vardata[x].trail_pos; }
+
 public:
     Solver() : ok               (true)
              , cla_inc          (1)
              , cla_decay        (1)
              , var_inc          (1)
              , var_decay        (1)
-             , order            (assigns, activity)
+             , order            (assigns, decision, activity)
+             , card_confl       (NULL)
+             , xor_confl        (NULL)
+             , chrono_on        (false)
              , qhead            (0)
              , simpDB_assigns   (0)
              , simpDB_props     (0)
+             , solve_start      (0)
+             , budget_countdown (0)
+             , budget_out       (false)
+             , inprocess_next   (0)
+             , inprocess_props  (0)
+             , probe_next       (0)
+             , gauss_done       (false)
+             , random_seed      (91648253)
              , default_params   (SearchParams(0.95, 0.999, 0.02))
              , expensive_ccmin  (true)
+             , reuse_trail      (false)
+             , chrono_backtrack (0)
              , proof            (NULL)
+             , proof_economy    (0)
+             , lazy_units       (false)
              , verbosity        (0)
+             , conflict_budget  (-1)
+             , propagation_budget(-1)
+             , time_budget      (-1)
+             , mem_budget       (-1)
+             , inprocessing     (false)
+             , probing          (false)
+             , gauss            (false)
+             , inprocess_effort (0.1)
+             , local_search_flips(0)
              , progress_estimate(0)
              , conflict_id      (ClauseId_NULL)
              {
@@ -151,6 +266,12 @@ public:
    ~Solver() {
        for (int i = 0; i < learnts.size(); i++) remove(learnts[i], true);
        for (int i = 0; i < clauses.size(); i++) if (clauses[i] != NULL) remove(clauses[i], true);
+       for (int i = 0; i < cards.size(); i++) delete cards[i];
+       for (int i = 0; i < xors.size(); i++) delete xors[i];
+       for (int i = 0; i < nVars(); i++) if ((card_reason[i] != NULL || xor_reason[i] != NULL) && reason(i) != NULL) xfree(reason(i));
+       if (card_confl != NULL) xfree(card_confl);
+       if (xor_confl  != NULL) xfree(xor_confl);
+       deleteXorRows();
        remove(propagate_tmpbin, true);
        remove(analyze_tmpbin, true); 
    }
@@ -163,6 +284,7 @@ public:
     int     nAssigns() { return trail.size(); }
     int     nClauses() { return clauses.size(); }
     int     nLearnts() { return learnts.size(); }
+    int     nCards  () { return cards.size(); }
 
     // Statistics: (read-only member variable)
     //
@@ -172,24 +294,54 @@ public:
     //
     SearchParams    default_params;     // Restart frequency etc.
     bool            expensive_ccmin;    // Controls conflict clause minimization. TRUE by default.
+    bool            reuse_trail;        // Restarts keep the decisions that the search would make again. FALSE by default.
+    int             chrono_backtrack;   // If positive, a conflict whose backjump would undo more than this many levels backtracks one level only, keeping the trail below it. Not with assumptions, cardinality constraints or 'gauss'. 0 by default.
     Proof*          proof;              // Set this directly after constructing 'Solver' to enable proof logging. Initialized to NULL.
+    int             proof_economy;      // If positive (and logging), 'analyze()' resolves each level 0 unit once per chain, and minimization removes a literal only if that takes at most this many resolutions. 0 by default.
+    bool            lazy_units;         // If TRUE (and logging), a level 0 unit found by propagation is logged only when a chain first uses it (its reason clause is kept until then). FALSE by default.
     int             verbosity;          // Verbosity level. 0=silent, 1=some progress report, 2=everything
 
+    // Resource budgets: (negative values mean no limit; checked between conflicts in 'search()')
+    //
+    int64           conflict_budget;    // Give up when 'stats.conflicts' reaches this value.
+    int64           propagation_budget; // Give up when 'stats.propagations' reaches this value.
+    double          time_budget;        // Give up after this many seconds of wall-clock time spent in 'solve()'.
+    int64           mem_budget;         // Give up when the process uses more than this many bytes.
+
+    // Inprocessing: (run from 'simplifyDB()' at geometrically growing conflict intervals)
+    //
+    bool            inprocessing;       // Strengthen clauses, substitute equivalent literals and vivify learnt clauses. FALSE by default.
+    bool            probing;            // Failed-literal probing with hyper-binary resolution. FALSE by default.
+    bool            gauss;              // Gauss-Jordan elimination on the XORs found in the problem (once, before search); the rows are then propagated as XOR constraints. FALSE by default.
+    double          inprocess_effort;   // Vivification and probing may each use this fraction of the propagations made since the previous pass.
+
+    // Local search: (no assumptions; not with cardinality constraints)
+    //
+    int64           local_search_flips; // If positive, 'solve()' tries local search with this many flips before the first restart, and twice as many before restarts 1, 3, 7, ... each time. 0 by default.
+
     // Problem specification:
     //
-    Var     newVar    ();
+    Var     newVar    (bool decision_var = true);
+    void    setDecisionVar(Var x, bool b)   { decision[x] = b; if (b) order.undo(x); }
     int     nVars     ()                    { return assigns.size(); }
     void    addUnit   (Lit p)               { addUnit_tmp   [0] = p; addClause(addUnit_tmp); }
     void    addBinary (Lit p, Lit q)        { addBinary_tmp [0] = p; addBinary_tmp [1] = q; addClause(addBinary_tmp); }
     void    addTernary(Lit p, Lit q, Lit r) { addTernary_tmp[0] = p; addTernary_tmp[1] = q; addTernary_tmp[2] = r; addClause(addTernary_tmp); }
     void    addClause (const vec<Lit>& ps)  { newClause(ps); }  // (used to be a difference between internal and external method...)
+    void    addCard   (const vec<Lit>& ps, int bound);     // (at least 'bound' of 'ps' are true)
+    void    addLearnt (const vec<Lit>& ps, ClauseId id);   // (an implied clause, e.g. learnt in an earlier run)
+    void    getLearnts(vec<vec<Lit> >& out, vec<ClauseId>& ids, int max_size, int max_count);
 
     // Solving:
     //
     bool    okay() { return ok; }       // FALSE means solver is in an conflicting state (must never be used again!)
     void    simplifyDB();
-    bool    solve(const vec<Lit>& assumps);
+    lbool   solveLimited(const vec<Lit>& assumps);  // 'l_Undef' means a resource budget ran out before an answer was found.
+    bool    solve(const vec<Lit>& assumps) { return solveLimited(assumps) == l_True; }
     bool    solve() { vec<Lit> tmp; return solve(tmp); }
+    lbool   solveLocal(int64 max_flips);    // Local search only: 'l_Undef' if no model was found within 'max_flips' flips (negative: no limit) or the budgets.
+    void    shrinkModel(const vec<char>& original, vec<Lit>& out);
+    void    makeCubes (int depth, vec<vec<Lit> >& out);         // (split into cubes for separate 'solve()' calls)
 
     double      progress_estimate;  // Set by 'search()'.
     vec<lbool>  model;              // If problem is satisfiable, this vector contains the model (if any).
@@ -111,6 +111,40 @@ inline Clause* Clause_new(bool learnt, const vec<Lit>& ps, ClauseId id = ClauseI
     return new (mem) Clause(learnt, ps, id); }
 
 
+//=================================================================================================
+// Card -- a cardinality constraint:
+
+
+// At least 'bound' of the literals are true. The first 'nWatched()' literals are watched. 'root' is
+// the position of the constraint in the input, used as the root index of its explanations in the
+// proof.
+struct Card {
+    vec<Lit>    lits;
+    int         bound;
+    int         root;
+
+    Card(const vec<Lit>& ps, int b, int r) : bound(b), root(r) { ps.copyTo(lits); }
+    int         nWatched() const { return min(bound + 1, lits.size()); }
+};
+
+
+//=================================================================================================
+// Xor -- an XOR constraint:
+
+
+// The variables add up to 'rhs' (mod 2). The first two variables are watched. With proof logging,
+// 'from' lists the XOR constraints recovered from the problem clauses that add up to this one
+// (their clauses prove its explanations), and 'cancelled' the variables that cancel out in the sum.
+struct Xor {
+    vec<Var>    vars;
+    bool        rhs;
+    vec<int>    from;
+    vec<Var>    cancelled;
+
+    Xor(const vec<Var>& vs, bool r) : rhs(r) { vs.copyTo(vars); }
+};
+
+
 //=================================================================================================
 // GClause -- Generalize clause:
 
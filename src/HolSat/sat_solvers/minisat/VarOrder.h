@@ -27,48 +27,62 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 //=================================================================================================
 
 
-struct VarOrder_lt {
-    const vec<double>&  activity;
-    bool operator () (Var x, Var y) { return activity[x] > activity[y]; }
-    VarOrder_lt(const vec<double>&  act) : activity(act) { }
-};
-
 class VarOrder {
     const vec<char>&    assigns;     // var->val. Pointer to external assignment table.
-    const vec<double>&  activity;    // var->act. Pointer to external activity table.
-    Heap<VarOrder_lt>   heap;
+    const vec<char>&    decision;    // var->bool. Pointer to external table of decision variables (others are never selected).
+    const vec<float>&   activity;    // var->act. Pointer to external activity table.
+    ActHeap             heap;        // (keeps its own copy of the activity of each variable in it)
+    ActHeap             rest;        // The non-decision variables, by activity (only branched on when no decision variable is left).
     double              random_seed; // For the internal random number generator
 
 public:
-    VarOrder(const vec<char>& ass, const vec<double>& act) :
-        assigns(ass), activity(act), heap(VarOrder_lt(act)), random_seed(91648253)
+    VarOrder(const vec<char>& ass, const vec<char>& dec, const vec<float>& act) :
+        assigns(ass), decision(dec), activity(act), random_seed(91648253)
         { }
 
     inline void newVar(void);
     inline void update(Var x);                  // Called when variable increased in activity.
-    inline void undo(Var x);                    // Called when variable is unassigned and may be selected again.
+    inline void undo(Var x);                    // Called when variable is unassigned and may be selected again (also when it becomes a decision variable).
+    inline void rescale(float factor);          // Called when all activities are multiplied by 'factor'.
     inline Var  select(double random_freq =.0); // Selects a new, unassigned variable (or 'var_Undef' if none exists).
+    inline Var  peek  (void);                   // The variable 'select()' would take by activity, without taking it.
+    inline Var  selectRest(void);               // Selects the unassigned non-decision variable of highest activity (or 'var_Undef').
 };
 
 
 void VarOrder::newVar(void)
 {
     heap.setBounds(assigns.size());
-    heap.insert(assigns.size()-1);
+    rest.setBounds(assigns.size());
+    if (decision[assigns.size()-1])
+        heap.insert(assigns.size()-1, activity[assigns.size()-1]);
+    else
+        rest.insert(assigns.size()-1, activity[assigns.size()-1]);
 }
 
 
 void VarOrder::update(Var x)
 {
     if (heap.inHeap(x))
-        heap.increase(x);
+        heap.increase(x, activity[x]);
+    if (rest.inHeap(x))
+        rest.increase(x, activity[x]);
 }
 
 
 void VarOrder::undo(Var x)
 {
-    if (!heap.inHeap(x))
-        heap.insert(x);
+    if (!heap.inHeap(x) && decision[x])
+        heap.insert(x, activity[x]);
+    else if (!rest.inHeap(x) && !decision[x])
+        rest.insert(x, activity[x]);
+}
+
+
+void VarOrder::rescale(float factor)
+{
+    heap.rescale(factor);
+    rest.rescale(factor);
 }
 
 
@@ -77,17 +91,42 @@ Var VarOrder::select(double random_var_freq)
     // Random decision:
     if (drand(random_seed) < random_var_freq && !heap.empty()){
         Var next = irand(random_seed,assigns.size());
-        if (toLbool(assigns[next]) == l_Undef)
+        if (toLbool(assigns[next]) == l_Undef && decision[next])
             return next;
     }
 
     // Activity based decision:
     while (!heap.empty()){
-        Var next = heap.getmin();
-        if (toLbool(assigns[next]) == l_Undef)
+        Var next = heap.getmax();
+        if (toLbool(assigns[next]) == l_Undef){
+            if (decision[next]) return next;
+            undo(next); }       // (no longer a decision variable: move it to 'rest')
+    }
+
+    return var_Undef;
+}
+
+
+Var VarOrder::peek(void)
+{
+    while (!heap.empty()){
+        Var next = heap.top();
+        if (toLbool(assigns[next]) == l_Undef && decision[next])
             return next;
+        heap.getmax();      // (assigned variables are put back by 'undo()')
+        if (toLbool(assigns[next]) == l_Undef) undo(next);
     }
+    return var_Undef;
+}
+
 
+Var VarOrder::selectRest(void)
+{
+    while (!rest.empty()){
+        Var next = rest.getmax();
+        if (toLbool(assigns[next]) == l_Undef && !decision[next])
+            return next;
+    }
     return var_Undef;
 }
 
@@ -0,0 +1,136 @@
+#!/bin/sh
+##
+##  Benchmark driver for MiniSat.
+##
+##    usage: bench.sh [-T <seconds>] [-o <csv file>] <cnf dir> <minisat> [<other minisat>]
+##
+##  Every *.cnf file in <cnf dir> is solved by each build, with proof logging off and on (each run
+##  limited to <seconds>, default 600, by 'timeout', or 'ulimit -t' where there is none, so that
+##  builds without a time limit option can be compared). For UNSAT problems the proof is then
+##  compressed and saved ('-x -p') and checked ('-c') in two more runs. Times are CPU seconds as
+##  reported by MiniSat; "overhead" is the extra solve time with proof logging ("-" if either time
+##  is zero). Runs that hit the limit are reported as UNKNOWN. One line per problem and build is
+##  printed, and appended to the CSV file if given:
+##
+##    file,build,result,time,confl/s,props/s,peak_mb,proof_time,overhead%,compress,check,proof_peak_mb
+##
+##  Runs that end without an answer, failed proof checks and (with two builds) differing answers are
+##  reported, and the exit code is then 1. With two builds, totals over the problems solved by both
+##  follow.
+##
+
+timeout=600
+csv=
+while [ $# -gt 0 ]; do
+    case "$1" in
+    -T) timeout="$2"; shift 2 ;;
+    -o) csv="$2"; shift 2 ;;
+    *)  break ;;
+    esac
+done
+if [ $# -lt 2 ] || [ $# -gt 3 ] || [ ! -d "$1" ]; then
+    echo "usage: bench.sh [-T <seconds>] [-o <csv file>] <cnf dir> <minisat> [<other minisat>]" >&2
+    exit 2
+fi
+dir="$1"; shift
+
+tmp=`mktemp -d "${TMPDIR:-/tmp}/minisat-bench.XXXXXX"` || exit 2
+trap 'rm -rf "$tmp"' 0
+trap 'exit 1' 1 2 15
+
+# Run the arguments with the time limit, output to 'out'; 'rc' is the exit code, and 'limited'
+# tells if the run was stopped by the limit:
+if command -v timeout >/dev/null 2>&1; then
+    run() { timeout -s INT "$timeout" "$@" > "$tmp/out" 2>&1; rc=$?; }
+    limited() { [ "$rc" = 124 ]; }
+else
+    run() { (ulimit -S -t "$timeout"; exec "$@") > "$tmp/out" 2>&1; rc=$?; }
+    limited() { [ "$rc" -gt 128 ] && [ "`kill -l "$rc"`" = XCPU ]; }
+fi
+
+# Field of the last line of 'out' starting with the first argument, or "-":
+field() {
+    v=`grep "^$1" "$tmp/out" | tail -1 | awk -v n="$2" '{ print $n }' | tr -d '('`
+    echo "${v:--}"
+}
+
+answer() {
+    v=`grep -E '^(SATISFIABLE|UNSATISFIABLE|UNKNOWN)$' "$tmp/out" | tail -1`
+    [ -z "$v" ] && limited && v=UNKNOWN
+    case "$v" in
+    SATISFIABLE)   echo SAT ;;
+    UNSATISFIABLE) echo UNSAT ;;
+    UNKNOWN)       echo UNKNOWN ;;
+    *)             echo ERROR ;;
+    esac
+}
+
+status=0
+header="file,build,result,time,confl/s,props/s,peak_mb,proof_time,overhead%,compress,check,proof_peak_mb"
+echo "$header"
+[ -n "$csv" ] && [ ! -s "$csv" ] && echo "$header" > "$csv"
+
+for f in "$dir"/*.cnf; do
+    [ -f "$f" ] || continue
+    name=`basename "$f"`
+    for exe in "$@"; do
+        run "$exe" "$f"
+        result=`answer`
+        [ "$result" = ERROR ] && status=1
+        time=`field "CPU time" 4`
+        cps=`field conflicts 4`
+        pps=`field propagations 4`
+        peak=`field "Peak memory" 4`
+
+        rm -f "$tmp/proof"
+        run "$exe" "$f" -p "$tmp/proof"
+        ptime=`field "CPU time" 4`
+        ppeak=`field "Peak memory" 4`
+        compress=-; check=-
+        if [ "$result" = UNSAT ] && [ "`answer`" = UNSAT ]; then
+            rm -f "$tmp/proof"
+            run "$exe" "$f" -x -p "$tmp/proof"
+            compress=`field "Extra CPU time" 5`
+            run "$exe" "$f" -c
+            check=`field "Extra CPU time" 5`
+            v=`field "Peak memory" 4`
+            [ "$v" != - ] && ppeak="$v"
+            if limited; then
+                :
+            elif ! grep -q "^Final clause: <empty>" "$tmp/out" || grep -q "PROOF ERROR" "$tmp/out"; then
+                echo "PROOF CHECK FAILED: $name ($exe)" >&2
+                status=1
+            fi
+        fi
+        overhead=`echo "$time $ptime" | awk '{ if ($1 > 0 && $2 != "-" && $2 > 0) printf "%.1f", ($2 - $1) * 100 / $1; else print "-" }'`
+
+        line="$name,$exe,$result,$time,$cps,$pps,$peak,$ptime,$overhead,$compress,$check,$ppeak"
+        echo "$line"
+        echo "$line" >> "$tmp/rows"
+        [ -n "$csv" ] && echo "$line" >> "$csv"
+    done
+done
+[ -f "$tmp/rows" ] || { echo "No *.cnf files in $dir" >&2; exit 2; }
+
+# Compare the builds:
+if [ $# -eq 2 ]; then
+    echo
+    awk -F, -v a="$1" -v b="$2" '
+        $2 == a { res[$1] = $3; t[$1] = $4; pt[$1] = $8 }
+        $2 == b && ($1 in res) {
+            if (res[$1] != $3 && res[$1] != "UNKNOWN" && $3 != "UNKNOWN"){
+                print "ANSWER MISMATCH: " $1 " (" res[$1] " / " $3 ")"; bad = 1 }
+            if (res[$1] == "UNKNOWN" || $3 == "UNKNOWN" || t[$1] == "-" || $4 == "-") next
+            n++; ta += t[$1]; tb += $4
+            if (pt[$1] != "-" && $8 != "-"){ pa += pt[$1]; pb += $8 } }
+        END {
+            printf "Solved by both        : %d\n", n
+            printf "Total time            : %.2f s / %.2f s", ta, tb
+            if (ta > 0) printf "   (%.3f)", tb / ta
+            printf "\n"
+            printf "Total time with proof : %.2f s / %.2f s", pa, pb
+            if (pa > 0) printf "   (%.3f)", pb / pa
+            printf "\n"
+            exit bad }' "$tmp/rows" || status=1
+fi
+exit $status